@@ -1,30 +1,165 @@
 #include "io_utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 namespace fs = std::filesystem;
 
-static bool has_text_ext(const fs::path& p) {
-    auto ext = p.extension().string();
-    for (auto& c : ext) c = (char)tolower((unsigned char)c);
-    return ext == ".txt" || ext == ".md";
+static std::string to_lower(std::string s) {
+    for (auto& c : s) c = (char)tolower((unsigned char)c);
+    return s;
 }
 
-std::vector<std::string> list_text_files(const std::string& rootDir) {
-    std::vector<std::string> out;
-    fs::path root(rootDir);
-    if (!fs::exists(root)) return out;
-    if (fs::is_regular_file(root)) {
-        if (has_text_ext(root)) out.push_back(root.string());
-        return out;
+static bool has_wanted_ext(const fs::path& p, const std::vector<std::string>& exts) {
+    if (exts.empty()) return true;
+    const auto ext = to_lower(p.extension().string());
+    return std::find(exts.begin(), exts.end(), ext) != exts.end();
+}
+
+bool glob_match(const std::string& pat, const std::string& s) {
+    size_t p = 0, i = 0, star = std::string::npos, mark = 0;
+    while (i < s.size()) {
+        if (p < pat.size() && (pat[p] == '?' || pat[p] == s[i])) { ++p; ++i; }
+        else if (p < pat.size() && pat[p] == '*') { star = p++; mark = i; }
+        else if (star != std::string::npos) { p = star + 1; i = ++mark; }
+        else return false;
     }
-    for (auto& entry : fs::recursive_directory_iterator(root)) {
-        if (entry.is_regular_file() && has_text_ext(entry.path())) {
-            out.push_back(entry.path().string());
+    while (p < pat.size() && pat[p] == '*') ++p;
+    return p == pat.size();
+}
+
+static bool is_ignored(const fs::path& p, const fs::path& root, const std::vector<std::string>& patterns) {
+    if (patterns.empty()) return false;
+    const std::string name = p.filename().string();
+    std::string rel;
+    for (const auto& pat : patterns) {
+        if (pat.find('/') == std::string::npos) {
+            if (glob_match(pat, name)) return true;
+        } else {
+            if (rel.empty()) rel = p.lexically_relative(root).generic_string();
+            if (glob_match(pat, rel)) return true;
         }
     }
+    return false;
+}
+
+namespace {
+
+// Per-walker directory deque: the owner pops from the back (depth-first, warm
+// dentry cache), idle walkers steal from the front (largest pending subtrees).
+struct DirQueue {
+    std::mutex mu;
+    std::deque<fs::path> dirs;
+};
+
+}
+
+void walk_text_files(const std::string& rootDir, const WalkOptions& opts,
+                     const std::function<bool(const std::string&)>& on_file) {
+    std::vector<std::string> exts;
+    for (const auto& e : opts.extensions) {
+        if (e.empty()) continue;
+        exts.push_back(to_lower(e[0] == '.' ? e : "." + e));
+    }
+
+    const fs::path root(rootDir);
+    std::error_code ec;
+    if (!fs::exists(root, ec)) return;
+    if (fs::is_regular_file(root, ec)) {
+        if (has_wanted_ext(root, exts)) on_file(root.string());
+        return;
+    }
+
+    int n = opts.walk_threads;
+    if (n <= 0) n = std::clamp((int)std::thread::hardware_concurrency(), 1, 8);
+    std::vector<DirQueue> queues((size_t)n);
+    std::atomic<size_t> pending{1}; // queued or in-progress directories
+    std::atomic<size_t> queued{1};  // directories sitting in some queue
+    std::atomic<bool> stop{false};
+    queues[0].dirs.push_back(root);
+
+    // Idle walkers sleep here instead of polling, which matters when one
+    // readdir on a network mount blocks for seconds.
+    std::mutex idle_mu;
+    std::condition_variable idle_cv;
+    auto wake = [&](bool all) {
+        std::lock_guard<std::mutex> lock(idle_mu);
+        if (all) idle_cv.notify_all();
+        else idle_cv.notify_one();
+    };
+
+    auto take = [&](int self, fs::path& out) {
+        {
+            auto& q = queues[(size_t)self];
+            std::lock_guard<std::mutex> lock(q.mu);
+            if (!q.dirs.empty()) { out = std::move(q.dirs.back()); q.dirs.pop_back(); --queued; return true; }
+        }
+        for (int k = 1; k < n; ++k) {
+            auto& q = queues[(size_t)((self + k) % n)];
+            std::lock_guard<std::mutex> lock(q.mu);
+            if (!q.dirs.empty()) { out = std::move(q.dirs.front()); q.dirs.pop_front(); --queued; return true; }
+        }
+        return false;
+    };
+
+    auto worker = [&](int self) {
+        fs::path dir;
+        while (pending.load() > 0 && !stop.load()) {
+            if (!take(self, dir)) {
+                std::unique_lock<std::mutex> lock(idle_mu);
+                idle_cv.wait(lock, [&] { return queued.load() > 0 || pending.load() == 0 || stop.load(); });
+                continue;
+            }
+            std::error_code it_ec;
+            fs::directory_iterator it(dir, it_ec);
+            for (; !it_ec && it != fs::directory_iterator(); it.increment(it_ec)) {
+                const auto& entry = *it;
+                if (is_ignored(entry.path(), root, opts.ignore_patterns)) continue;
+                std::error_code tec;
+                if (entry.is_directory(tec) && !entry.is_symlink(tec)) {
+                    ++pending;
+                    {
+                        auto& q = queues[(size_t)self];
+                        std::lock_guard<std::mutex> lock(q.mu);
+                        q.dirs.push_back(entry.path());
+                        ++queued;
+                    }
+                    wake(false);
+                } else if (entry.is_regular_file(tec) && has_wanted_ext(entry.path(), exts)) {
+                    if (!on_file(entry.path().string())) { stop = true; wake(true); break; }
+                }
+            }
+            if (it_ec) {
+                // One write per line so reports from concurrent walkers don't interleave.
+                std::cerr << ("Failed to read directory: " + dir.string() + ": " + it_ec.message() + "\n");
+            }
+            if (--pending == 0) wake(true);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < n; ++i) threads.emplace_back(worker, i);
+    worker(0);
+    for (auto& t : threads) t.join();
+}
+
+std::vector<std::string> list_text_files(const std::string& rootDir, const WalkOptions& opts) {
+    std::vector<std::string> out;
+    std::mutex mu;
+    walk_text_files(rootDir, opts, [&](const std::string& path) {
+        std::lock_guard<std::mutex> lock(mu);
+        out.push_back(path);
+        return true;
+    });
     return out;
 }
 
@@ -36,3 +171,88 @@ std::string read_file_text(const std::string& path) {
     return ss.str();
 }
 
+struct TextFileStream::State {
+    std::mutex mu;
+    std::condition_variable paths_cv; // paths queued or walk finished
+    std::condition_variable ready_cv; // record ready or readers finished
+    std::condition_variable space_cv; // readahead window advanced
+    // Paths are numbered at discovery; readers may finish out of order, so
+    // next() hands records out strictly by sequence number.
+    std::deque<std::pair<size_t, std::string>> paths;
+    std::map<size_t, FileRecord> ready;
+    size_t next_seq = 0; // assigned to the next discovered path
+    size_t next_out = 0; // sequence number next() returns next
+    size_t readahead = 1;
+    bool walk_done = false;
+    int readers_left = 0;
+    bool stop = false;
+    std::vector<std::thread> threads;
+};
+
+TextFileStream::TextFileStream(std::string rootDir, WalkOptions opts)
+    : st_(std::make_unique<State>()) {
+    State* st = st_.get();
+    st->readahead = std::max<size_t>(opts.readahead, 1);
+    const int readers = std::max(opts.read_threads, 1);
+    st->readers_left = readers;
+
+    st->threads.emplace_back([st, root = std::move(rootDir), opts]() {
+        walk_text_files(root, opts, [st](const std::string& path) {
+            std::lock_guard<std::mutex> lock(st->mu);
+            if (st->stop) return false;
+            st->paths.emplace_back(st->next_seq++, path);
+            st->paths_cv.notify_one();
+            return true;
+        });
+        std::lock_guard<std::mutex> lock(st->mu);
+        st->walk_done = true;
+        st->paths_cv.notify_all();
+    });
+
+    for (int i = 0; i < readers; ++i) {
+        st->threads.emplace_back([st]() {
+            std::unique_lock<std::mutex> lock(st->mu);
+            while (true) {
+                st->paths_cv.wait(lock, [st] { return st->stop || st->walk_done || !st->paths.empty(); });
+                if (st->stop || st->paths.empty()) break;
+                const size_t seq = st->paths.front().first;
+                FileRecord rec;
+                rec.path = std::move(st->paths.front().second);
+                st->paths.pop_front();
+                // Paths leave the queue in order, so the reader holding next_out never waits here.
+                st->space_cv.wait(lock, [st, seq] { return st->stop || seq < st->next_out + st->readahead; });
+                if (st->stop) break;
+                lock.unlock();
+                rec.content = read_file_text(rec.path);
+                lock.lock();
+                st->ready.emplace(seq, std::move(rec));
+                if (seq == st->next_out) st->ready_cv.notify_one();
+            }
+            --st->readers_left;
+            st->ready_cv.notify_all();
+        });
+    }
+}
+
+TextFileStream::~TextFileStream() {
+    {
+        std::lock_guard<std::mutex> lock(st_->mu);
+        st_->stop = true;
+    }
+    st_->paths_cv.notify_all();
+    st_->space_cv.notify_all();
+    for (auto& t : st_->threads) t.join();
+}
+
+bool TextFileStream::next(FileRecord& out) {
+    std::unique_lock<std::mutex> lock(st_->mu);
+    auto has_next = [this] { return !st_->ready.empty() && st_->ready.begin()->first == st_->next_out; };
+    st_->ready_cv.wait(lock, [&] { return has_next() || st_->readers_left == 0; });
+    if (!has_next()) return false;
+    auto it = st_->ready.begin();
+    out = std::move(it->second);
+    st_->ready.erase(it);
+    ++st_->next_out;
+    st_->space_cv.notify_all();
+    return true;
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -8,9 +11,48 @@ struct FileRecord {
     std::string content;
 };
 
-// Recursively collect .txt and .md files under root.
-std::vector<std::string> list_text_files(const std::string& rootDir);
+struct WalkOptions {
+    // Accepted extensions (e.g. ".txt"), case-insensitive; empty accepts every file.
+    std::vector<std::string> extensions = {".txt", ".md"};
+    // Globs (`*`, `?`) matched against each entry name, or against the path
+    // relative to the root when the pattern contains '/'. Ignored directories
+    // are not descended into.
+    std::vector<std::string> ignore_patterns;
+    int walk_threads = 0;  // 0 = min(hardware threads, 8)
+    int read_threads = 4;
+    size_t readahead = 64; // files read ahead of the consumer
+};
+
+// Glob match supporting `*` and `?` (the --ignore pattern syntax).
+bool glob_match(const std::string& pattern, const std::string& text);
+
+// Parallel, work-stealing walk under root. on_file is called from the walker
+// threads as soon as each matching file is found; returning false stops the walk.
+void walk_text_files(const std::string& rootDir, const WalkOptions& opts,
+                     const std::function<bool(const std::string&)>& on_file);
+
+// Recursively collect matching files under root (.txt and .md by default).
+std::vector<std::string> list_text_files(const std::string& rootDir, const WalkOptions& opts = {});
 
 // Read entire file as UTF-8 text (best-effort).
 std::string read_file_text(const std::string& path);
 
+// Streams files from walk_text_files, read ahead of the consumer on background
+// threads so ingest can start on the first file while the walk continues.
+// Files arrive in discovery order regardless of read_threads; that order is
+// only reproducible across runs with walk_threads == 1.
+class TextFileStream {
+public:
+    explicit TextFileStream(std::string rootDir, WalkOptions opts = {});
+    ~TextFileStream();
+
+    TextFileStream(const TextFileStream&) = delete;
+    TextFileStream& operator=(const TextFileStream&) = delete;
+
+    // Blocks until the next file is read; returns false once all files are consumed.
+    bool next(FileRecord& out);
+
+private:
+    struct State;
+    std::unique_ptr<State> st_;
+};
@@ -3,6 +3,8 @@
 #include <vector>
 #include <filesystem>
 #include <cstdlib>
+#include <chrono>
+#include <utility>
 
 #include "io_utils.h"
 #include "text_chunker.h"
@@ -14,7 +16,11 @@
 static void usage() {
     std::cout << "Usage:\n"
                  "  rag ingest --dir <path> --store <dir> --embed-model <path> [--chunk-size N] [--chunk-overlap N]\n"
-                 "  rag query  --store <dir> --llm-model <name> --question <text> [--k N] [--max-tokens N] [--temp F] [--embed-model <name>]\n";
+                 "             [--ext .txt,.md] [--ignore <glob,...>] [--walk-threads N] [--read-threads N] [--readahead N]\n"
+                 "  rag query  --store <dir> --llm-model <name> --question <text> [--k N] [--max-tokens N] [--temp F] [--embed-model <name>]\n"
+                 "Common options:\n"
+                 "  --ollama-host <host> (default 127.0.0.1), --ollama-port N (default 11434)\n"
+                 "  --timings            print per-stage wall times to stderr\n";
 }
 
 static std::string get_flag(int argc, char** argv, const std::string& name, const std::string& def = "") {
@@ -24,6 +30,38 @@ static std::string get_flag(int argc, char** argv, const std::string& name, cons
     return def;
 }
 
+static bool has_flag(int argc, char** argv, const std::string& name) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == name) return true;
+    }
+    return false;
+}
+
+static std::vector<std::string> split_list(const std::string& s) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+        if (end == std::string::npos) end = s.size();
+        if (end > start) out.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+    return out;
+}
+
+using Clock = std::chrono::steady_clock;
+
+static double ms_since(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Single machine-readable line, parsed by tools/rag_loadgen.
+static void print_timings(const std::vector<std::pair<std::string, double>>& stages) {
+    std::cerr << "timings:";
+    for (const auto& s : stages) std::cerr << " " << s.first << "_ms=" << s.second;
+    std::cerr << "\n";
+}
+
 static std::string build_rag_prompt(const std::string& question, const std::vector<SearchResult>& ctx) {
     std::string prompt;
     prompt += "You are a helpful assistant. Answer the question using ONLY the context.\n";
@@ -41,6 +79,9 @@ static std::string build_rag_prompt(const std::string& question, const std::vect
 int main(int argc, char** argv) {
     if (argc < 2) { usage(); return 1; }
     std::string cmd = argv[1];
+    std::string ollama_host = get_flag(argc, argv, "--ollama-host", "127.0.0.1");
+    int ollama_port = std::stoi(get_flag(argc, argv, "--ollama-port", "11434"));
+    bool timings = has_flag(argc, argv, "--timings");
 
     if (cmd == "ingest") {
         std::string dir = get_flag(argc, argv, "--dir");
@@ -49,21 +90,40 @@ int main(int argc, char** argv) {
         int chunk_size = std::stoi(get_flag(argc, argv, "--chunk-size", "800"));
         int chunk_overlap = std::stoi(get_flag(argc, argv, "--chunk-overlap", "200"));
         if (dir.empty() || embed_model.empty()) { usage(); return 2; }
+        WalkOptions walk;
+        walk.extensions = split_list(get_flag(argc, argv, "--ext", ".txt,.md"));
+        walk.ignore_patterns = split_list(get_flag(argc, argv, "--ignore"));
+        walk.walk_threads = std::stoi(get_flag(argc, argv, "--walk-threads", "0"));
+        walk.read_threads = std::stoi(get_flag(argc, argv, "--read-threads", "4"));
+        walk.readahead = (size_t)std::stoul(get_flag(argc, argv, "--readahead", "64"));
 
         try {
-            OllamaClient oc;
+            OllamaClient oc(ollama_host, ollama_port);
             VectorStore vs(store);
 
-            auto files = list_text_files(dir);
-            std::cout << "Found " << files.size() << " files to ingest\n";
-            size_t added = 0;
+            // read = time blocked waiting on the walker/prefetch threads.
+            double first_chunk_ms = 0, read_ms = 0, chunk_ms = 0, embed_ms = 0, store_ms = 0;
+            const auto start = Clock::now();
+            TextFileStream files(dir, walk);
+            size_t n_files = 0, added = 0;
             bool store_inited = false;
-            for (const auto& f : files) {
-                std::string content = read_file_text(f);
-                auto chunks = chunk_text(content, (size_t)chunk_size, (size_t)chunk_overlap);
+            FileRecord rec;
+            while (true) {
+                auto t0 = Clock::now();
+                if (!files.next(rec)) break;
+                read_ms += ms_since(t0);
+                ++n_files;
+                const std::string& f = rec.path;
+                t0 = Clock::now();
+                auto chunks = chunk_text(rec.content, (size_t)chunk_size, (size_t)chunk_overlap);
+                chunk_ms += ms_since(t0);
+                if (n_files == 1) first_chunk_ms = ms_since(start);
                 for (size_t i = 0; i < chunks.size(); ++i) {
+                    t0 = Clock::now();
                     auto emb = oc.embed(embed_model, chunks[i]);
+                    embed_ms += ms_since(t0);
                     if (emb.empty()) { std::cerr << "Embedding failed via Ollama for chunk in: " << f << "\n"; continue; }
+                    t0 = Clock::now();
                     if (!store_inited) {
                         if (!vs.init_or_load((int)emb.size(), embed_model)) { std::cerr << "Failed to init/load store\n"; return 3; }
                         store_inited = true;
@@ -74,9 +134,15 @@ int main(int argc, char** argv) {
                     c.text = chunks[i];
                     c.embedding = std::move(emb);
                     if (vs.append(c)) ++added;
+                    store_ms += ms_since(t0);
                 }
             }
+            std::cout << "Ingested files: " << n_files << "\n";
             std::cout << "Ingested chunks: " << added << "\n";
+            if (timings) {
+                print_timings({{"first_chunk", first_chunk_ms}, {"read", read_ms}, {"chunk", chunk_ms},
+                               {"embed", embed_ms}, {"store", store_ms}});
+            }
         } catch (const std::exception& e) {
             std::cerr << "Error: " << e.what() << "\n"; return 10;
         }
@@ -94,30 +160,43 @@ int main(int argc, char** argv) {
         if (llm_model.empty() || question.empty()) { usage(); return 2; }
 
         try {
+            auto t0 = Clock::now();
             VectorStore vs(store);
             // Initialize with dummy values; will be loaded from meta
             if (!vs.init_or_load(0, "")) { std::cerr << "Failed to load store\n"; return 3; }
             std::string embed_model_path = !embed_model.empty() ? embed_model : vs.embed_model_name();
             if (embed_model_path.empty()) { std::cerr << "Embed model not specified and not found in store meta\n"; return 4; }
 
-            OllamaClient oc;
+            double load_ms = ms_since(t0);
+
+            OllamaClient oc(ollama_host, ollama_port);
+            t0 = Clock::now();
             auto qvec = oc.embed(embed_model_path, question);
+            double embed_ms = ms_since(t0);
             if (qvec.empty()) {
                 std::cerr << "Failed to get embeddings for the question. Ensure Ollama is running and the embedding model ('" << embed_model_path << "') is pulled.\n";
                 return 5;
             }
+            t0 = Clock::now();
             auto hits = vs.query(qvec, k);
+            double search_ms = ms_since(t0);
             if (hits.empty()) {
                 std::cout << "No context found in store.\n"; return 0;
             }
             auto prompt = build_rag_prompt(question, hits);
 
+            t0 = Clock::now();
             auto answer = oc.generate(llm_model, prompt, max_tokens, temp);
+            double generate_ms = ms_since(t0);
             if (answer.empty()) {
                 std::cerr << "No answer generated. Verify the LLM model ('" << llm_model << "') is available: try 'ollama pull " << llm_model << "' and test with 'ollama run " << llm_model << " \"hi\"'.\n";
                 return 6;
             }
             std::cout << answer << "\n";
+            if (timings) {
+                print_timings({{"load", load_ms}, {"embed", embed_ms}, {"search", search_ms},
+                               {"generate", generate_ms}});
+            }
         } catch (const std::exception& e) {
             std::cerr << "Error: " << e.what() << "\n"; return 10;
         }
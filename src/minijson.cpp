@@ -96,6 +96,14 @@ bool extract_int(const std::string& json, const std::string& key, int& out) {
     return endp != json.c_str() + vpos;
 }
 
+bool extract_bool(const std::string& json, const std::string& key, bool& out) {
+    size_t vpos = 0; if (!find_key_value_pos(json, key, vpos)) return false;
+    skip_ws(json, vpos);
+    if (json.compare(vpos, 4, "true") == 0) { out = true; return true; }
+    if (json.compare(vpos, 5, "false") == 0) { out = false; return true; }
+    return false;
+}
+
 bool extract_float_array(const std::string& json, const std::string& key, std::vector<float>& out) {
     size_t vpos = 0; if (!find_key_value_pos(json, key, vpos)) return false;
     skip_ws(json, vpos);
@@ -117,5 +125,23 @@ bool extract_float_array(const std::string& json, const std::string& key, std::v
     return true;
 }
 
+bool extract_string_array(const std::string& json, const std::string& key, std::vector<std::string>& out) {
+    size_t vpos = 0; if (!find_key_value_pos(json, key, vpos)) return false;
+    skip_ws(json, vpos);
+    if (vpos >= json.size() || json[vpos] != '[') return false;
+    ++vpos;
+    out.clear();
+    while (vpos < json.size()) {
+        skip_ws(json, vpos);
+        if (vpos < json.size() && json[vpos] == ']') { ++vpos; break; }
+        std::string v;
+        if (!parse_json_string(json, vpos, v)) return false;
+        out.push_back(std::move(v));
+        skip_ws(json, vpos);
+        if (vpos < json.size() && json[vpos] == ',') { ++vpos; continue; }
+        if (vpos < json.size() && json[vpos] == ']') { ++vpos; break; }
+    }
+    return true;
 }
 
+}
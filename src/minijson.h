@@ -16,8 +16,14 @@ bool extract_string(const std::string& json, const std::string& key, std::string
 // Extract an integer field from a flat JSON object: {"key":123, ...}
 bool extract_int(const std::string& json, const std::string& key, int& out);
 
+// Extract a boolean field: {"key":true, ...}
+bool extract_bool(const std::string& json, const std::string& key, bool& out);
+
 // Extract a float array field: {"key":[1.0,2.0,...]}
 bool extract_float_array(const std::string& json, const std::string& key, std::vector<float>& out);
 
+// Extract a string array field: {"key":["a","b",...]}
+bool extract_string_array(const std::string& json, const std::string& key, std::vector<std::string>& out);
+
 }
 
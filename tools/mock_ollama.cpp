@@ -0,0 +1,291 @@
+// Deterministic stand-in for a local Ollama server, used to load-test the
+// ingest and query paths without real models. Implements:
+//   POST /api/embeddings  {"model","prompt"}            -> {"embedding":[...]}
+//   POST /api/embed       {"model","input":str|[str]}   -> {"embeddings":[[...],...]}
+//   POST /api/generate    {"model","prompt","stream"}   -> single object or NDJSON stream
+// Embeddings are derived from a hash of (model, text), so repeated runs produce
+// byte-identical stores (given a fixed ingest order, i.e. `rag ingest
+// --walk-threads 1`). Latency and token rate are configurable.
+
+#include "minijson.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+struct MockConfig {
+    std::string host = "127.0.0.1";
+    int port = 11434;
+    int dim = 768;
+    int embed_latency_ms = 0;    // per embedding request
+    int generate_latency_ms = 0; // before the first token
+    double tokens_per_sec = 0;   // 0 = unlimited
+    int response_tokens = 32;    // capped by options.num_predict
+};
+
+static MockConfig g_cfg;
+
+static void usage() {
+    std::cout << "Usage:\n"
+                 "  mock_ollama [--host H] [--port N] [--dim N] [--embed-latency-ms N]\n"
+                 "              [--generate-latency-ms N] [--tokens-per-sec F] [--response-tokens N]\n";
+}
+
+static std::string get_flag(int argc, char** argv, const std::string& name, const std::string& def = "") {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == name) return argv[i+1];
+    }
+    return def;
+}
+
+static uint64_t fnv1a(const std::string& s, uint64_t h = 1469598103934665603ull) {
+    for (unsigned char c : s) { h ^= c; h *= 1099511628211ull; }
+    return h;
+}
+
+static uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// Unit-length vector seeded by (model, text).
+static std::vector<float> hash_embedding(const std::string& model, const std::string& text) {
+    uint64_t state = fnv1a(text, fnv1a(model + '\0'));
+    std::vector<float> v((size_t)g_cfg.dim);
+    double n = 0.0;
+    for (auto& x : v) {
+        x = (float)((double)(splitmix64(state) >> 11) / (double)(1ull << 53) * 2.0 - 1.0);
+        n += (double)x * x;
+    }
+    if (n > 0.0) {
+        float inv = (float)(1.0 / std::sqrt(n));
+        for (auto& x : v) x *= inv;
+    }
+    return v;
+}
+
+static void append_vector(std::string& out, const std::vector<float>& v) {
+    char buf[32];
+    out += '[';
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (i) out += ',';
+        snprintf(buf, sizeof(buf), "%.7g", v[i]);
+        out += buf;
+    }
+    out += ']';
+}
+
+static const char* const kWords[] = {
+    "the", "context", "answer", "model", "vector", "store", "chunk", "query",
+    "local", "embedding", "document", "source", "result", "token", "engine", "text",
+};
+
+// Deterministic filler token; a leading space mimics typical BPE output.
+static std::string mock_token(uint64_t& state) {
+    return std::string(" ") + kWords[splitmix64(state) % (sizeof(kWords) / sizeof(kWords[0]))];
+}
+
+static void sleep_ms(double ms) {
+    if (ms > 0) std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(ms));
+}
+
+static bool send_all(int fd, const std::string& data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = send(fd, data.data() + off, data.size() - off, 0);
+        if (n <= 0) return false;
+        off += (size_t)n;
+    }
+    return true;
+}
+
+static void send_response(int fd, int status, const std::string& body) {
+    const char* reason = status == 200 ? "OK" : status == 404 ? "Not Found" : "Bad Request";
+    std::string resp = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n"
+                       "Content-Type: application/json\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n\r\n" + body;
+    send_all(fd, resp);
+}
+
+static void send_error(int fd, int status, const std::string& msg) {
+    send_response(fd, status, "{\"error\":\"" + minijson::escape(msg) + "\"}");
+}
+
+static bool send_chunk(int fd, const std::string& data) {
+    char len[32];
+    snprintf(len, sizeof(len), "%zx\r\n", data.size());
+    return send_all(fd, len + data + "\r\n");
+}
+
+static void handle_embeddings(int fd, const std::string& body) {
+    std::string model, prompt;
+    minijson::extract_string(body, "model", model);
+    if (!minijson::extract_string(body, "prompt", prompt)) { send_error(fd, 400, "missing prompt"); return; }
+    sleep_ms(g_cfg.embed_latency_ms);
+    std::string out = "{\"embedding\":";
+    append_vector(out, hash_embedding(model, prompt));
+    out += "}";
+    send_response(fd, 200, out);
+}
+
+static void handle_embed(int fd, const std::string& body) {
+    std::string model;
+    minijson::extract_string(body, "model", model);
+    std::vector<std::string> inputs;
+    std::string single;
+    if (!minijson::extract_string_array(body, "input", inputs)) {
+        if (!minijson::extract_string(body, "input", single)) { send_error(fd, 400, "missing input"); return; }
+        inputs.push_back(std::move(single));
+    }
+    sleep_ms(g_cfg.embed_latency_ms);
+    std::string out = "{\"model\":\"" + minijson::escape(model) + "\",\"embeddings\":[";
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (i) out += ',';
+        append_vector(out, hash_embedding(model, inputs[i]));
+    }
+    out += "]}";
+    send_response(fd, 200, out);
+}
+
+static void handle_generate(int fd, const std::string& body) {
+    std::string model, prompt;
+    minijson::extract_string(body, "model", model);
+    if (!minijson::extract_string(body, "prompt", prompt)) { send_error(fd, 400, "missing prompt"); return; }
+    bool stream = true; // Ollama streams unless told otherwise
+    minijson::extract_bool(body, "stream", stream);
+    int n_tokens = g_cfg.response_tokens;
+    int num_predict = 0;
+    if (minijson::extract_int(body, "num_predict", num_predict) && num_predict > 0 && num_predict < n_tokens) {
+        n_tokens = num_predict;
+    }
+    const double token_ms = g_cfg.tokens_per_sec > 0 ? 1000.0 / g_cfg.tokens_per_sec : 0.0;
+    uint64_t state = fnv1a(prompt, fnv1a(model + '\0'));
+    const std::string model_json = "\"model\":\"" + minijson::escape(model) + "\"";
+
+    sleep_ms(g_cfg.generate_latency_ms);
+    if (!stream) {
+        std::string text;
+        for (int i = 0; i < n_tokens; ++i) text += mock_token(state);
+        sleep_ms(token_ms * n_tokens);
+        send_response(fd, 200, "{" + model_json + ",\"response\":\"" + minijson::escape(text) +
+                                   "\",\"done\":true,\"eval_count\":" + std::to_string(n_tokens) + "}");
+        return;
+    }
+    if (!send_all(fd, "HTTP/1.1 200 OK\r\n"
+                      "Content-Type: application/x-ndjson\r\n"
+                      "Transfer-Encoding: chunked\r\n"
+                      "Connection: close\r\n\r\n")) return;
+    for (int i = 0; i < n_tokens; ++i) {
+        if (i) sleep_ms(token_ms);
+        std::string line = "{" + model_json + ",\"response\":\"" + minijson::escape(mock_token(state)) + "\",\"done\":false}\n";
+        if (!send_chunk(fd, line)) return;
+    }
+    if (!send_chunk(fd, "{" + model_json + ",\"response\":\"\",\"done\":true,\"eval_count\":" +
+                            std::to_string(n_tokens) + "}\n")) return;
+    send_all(fd, "0\r\n\r\n");
+}
+
+// One request per connection (we always reply with Connection: close).
+static void handle_connection(int fd) {
+    std::string buf;
+    char tmp[8192];
+    size_t header_end = std::string::npos;
+    while (header_end == std::string::npos) {
+        ssize_t n = recv(fd, tmp, sizeof(tmp), 0);
+        if (n <= 0) { close(fd); return; }
+        buf.append(tmp, (size_t)n);
+        header_end = buf.find("\r\n\r\n");
+        if (header_end == std::string::npos && buf.size() > (1u << 20)) { close(fd); return; }
+    }
+    std::string head = buf.substr(0, header_end);
+    std::string body = buf.substr(header_end + 4);
+    for (auto& c : head) c = (char)tolower((unsigned char)c);
+
+    size_t content_length = 0;
+    size_t cl = head.find("\r\ncontent-length:");
+    if (cl != std::string::npos) content_length = (size_t)strtoull(head.c_str() + cl + 17, nullptr, 10);
+    // curl waits up to a second for this on larger bodies unless we answer.
+    if (head.find("\r\nexpect: 100-continue") != std::string::npos && body.size() < content_length) {
+        send_all(fd, "HTTP/1.1 100 Continue\r\n\r\n");
+    }
+    while (body.size() < content_length) {
+        ssize_t n = recv(fd, tmp, sizeof(tmp), 0);
+        if (n <= 0) { close(fd); return; }
+        body.append(tmp, (size_t)n);
+    }
+
+    size_t sp1 = head.find(' ');
+    size_t sp2 = sp1 == std::string::npos ? std::string::npos : head.find(' ', sp1 + 1);
+    std::string method = head.substr(0, sp1);
+    std::string path = sp2 == std::string::npos ? "" : head.substr(sp1 + 1, sp2 - sp1 - 1);
+
+    if (method != "post") send_error(fd, 404, "not found");
+    else if (path == "/api/embeddings") handle_embeddings(fd, body);
+    else if (path == "/api/embed") handle_embed(fd, body);
+    else if (path == "/api/generate") handle_generate(fd, body);
+    else send_error(fd, 404, "not found");
+    close(fd);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-h" || a == "--help") { usage(); return 0; }
+    }
+    try {
+        g_cfg.host = get_flag(argc, argv, "--host", g_cfg.host);
+        g_cfg.port = std::stoi(get_flag(argc, argv, "--port", std::to_string(g_cfg.port)));
+        g_cfg.dim = std::stoi(get_flag(argc, argv, "--dim", std::to_string(g_cfg.dim)));
+        g_cfg.embed_latency_ms = std::stoi(get_flag(argc, argv, "--embed-latency-ms", "0"));
+        g_cfg.generate_latency_ms = std::stoi(get_flag(argc, argv, "--generate-latency-ms", "0"));
+        g_cfg.tokens_per_sec = std::stod(get_flag(argc, argv, "--tokens-per-sec", "0"));
+        g_cfg.response_tokens = std::stoi(get_flag(argc, argv, "--response-tokens", std::to_string(g_cfg.response_tokens)));
+    } catch (const std::exception&) {
+        usage(); return 2;
+    }
+    if (g_cfg.dim <= 0) { usage(); return 2; }
+
+    signal(SIGPIPE, SIG_IGN);
+    int srv = socket(AF_INET, SOCK_STREAM, 0);
+    if (srv < 0) { perror("socket"); return 3; }
+    int one = 1;
+    setsockopt(srv, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)g_cfg.port);
+    if (inet_pton(AF_INET, g_cfg.host.c_str(), &addr.sin_addr) != 1) {
+        std::cerr << "Invalid --host: " << g_cfg.host << "\n"; return 2;
+    }
+    if (bind(srv, (sockaddr*)&addr, sizeof(addr)) != 0) { perror("bind"); return 3; }
+    if (listen(srv, 512) != 0) { perror("listen"); return 3; }
+    std::cout << "mock_ollama listening on " << g_cfg.host << ":" << g_cfg.port
+              << " (dim " << g_cfg.dim << ")" << std::endl;
+
+    while (true) {
+        int fd = accept(srv, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            perror("accept"); break;
+        }
+        std::thread(handle_connection, fd).detach();
+    }
+    close(srv);
+    return 0;
+}
@@ -0,0 +1,176 @@
+// End-to-end load generator: runs `rag` subcommands at a target concurrency and
+// reports throughput plus p50/p99 per stage. Stage times come from the
+// `timings:` line that `rag --timings` prints to stderr; "total" is the wall
+// time observed here, including process startup.
+//
+//   rag_loadgen --rag build/rag --concurrency 8 --requests 200 --
+//       query --store .rag_store --llm-model m --question "q{n}" --ollama-port 11500
+//
+// Every `{n}` in the passthrough args is replaced by the request index, which
+// lets ingest runs target separate stores (`--store /tmp/lg/{n}`).
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static void usage() {
+    std::cout << "Usage:\n"
+                 "  rag_loadgen [--rag <path>] [--concurrency N] [--requests N] [--verbose] -- <rag args...>\n"
+                 "  `{n}` in rag args is replaced with the request index; `--timings` is appended.\n";
+}
+
+static std::string shell_quote(const std::string& s) {
+    std::string out = "'";
+    for (char c : s) {
+        if (c == '\'') out += "'\\''";
+        else out += c;
+    }
+    out += "'";
+    return out;
+}
+
+static std::string replace_all(std::string s, const std::string& from, const std::string& to) {
+    for (size_t pos = s.find(from); pos != std::string::npos; pos = s.find(from, pos + to.size())) {
+        s.replace(pos, from.size(), to);
+    }
+    return s;
+}
+
+// Parse "timings: embed_ms=1.5 search_ms=0.2" into {embed: 1.5, search: 0.2}.
+static void parse_timings(const std::string& output, std::map<std::string, double>& out) {
+    size_t pos = output.rfind("timings:");
+    if (pos == std::string::npos) return;
+    size_t eol = output.find('\n', pos);
+    std::istringstream line(output.substr(pos + 8, eol == std::string::npos ? std::string::npos : eol - pos - 8));
+    std::string tok;
+    while (line >> tok) {
+        size_t eq = tok.find("_ms=");
+        if (eq == std::string::npos) continue;
+        out[tok.substr(0, eq)] = std::strtod(tok.c_str() + eq + 4, nullptr);
+    }
+}
+
+static int run_command(const std::string& cmd, std::string& output) {
+    std::array<char, 4096> buf{};
+#if defined(_WIN32)
+    FILE* pipe = _popen(cmd.c_str(), "r");
+#else
+    FILE* pipe = popen(cmd.c_str(), "r");
+#endif
+    if (!pipe) return -1;
+    while (true) {
+        size_t n = fread(buf.data(), 1, buf.size(), pipe);
+        if (n == 0) break;
+        output.append(buf.data(), n);
+    }
+#if defined(_WIN32)
+    return _pclose(pipe);
+#else
+    int status = pclose(pipe);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+static double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t idx = (size_t)(p * (double)(v.size() - 1) + 0.5);
+    return v[std::min(idx, v.size() - 1)];
+}
+
+int main(int argc, char** argv) {
+    std::string rag = "rag";
+    int concurrency = 4;
+    int requests = 100;
+    bool verbose = false;
+    std::vector<std::string> rag_args;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string a = argv[i];
+            if (a == "--") {
+                rag_args.assign(argv + i + 1, argv + argc);
+                break;
+            }
+            if (a == "--rag" && i + 1 < argc) rag = argv[++i];
+            else if (a == "--concurrency" && i + 1 < argc) concurrency = std::stoi(argv[++i]);
+            else if (a == "--requests" && i + 1 < argc) requests = std::stoi(argv[++i]);
+            else if (a == "--verbose") verbose = true;
+            else { usage(); return a == "-h" || a == "--help" ? 0 : 2; }
+        }
+    } catch (const std::exception&) {
+        usage(); return 2;
+    }
+    if (rag_args.empty() || concurrency <= 0 || requests <= 0) { usage(); return 2; }
+
+    std::atomic<int> next{0};
+    std::atomic<int> failures{0};
+    std::mutex mu;
+    std::map<std::string, std::vector<double>> stages;
+
+    auto worker = [&]() {
+        while (true) {
+            int n = next.fetch_add(1);
+            if (n >= requests) return;
+            std::string cmd = shell_quote(rag);
+            for (const auto& a : rag_args) cmd += " " + shell_quote(replace_all(a, "{n}", std::to_string(n)));
+            cmd += " --timings 2>&1";
+
+            std::string output;
+            auto t0 = Clock::now();
+            int rc = run_command(cmd, output);
+            double total_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+            std::map<std::string, double> t;
+            parse_timings(output, t);
+            std::lock_guard<std::mutex> lock(mu);
+            if (rc != 0 || t.empty()) {
+                ++failures;
+                if (verbose) std::cerr << "request " << n << " failed (exit " << rc << "):\n" << output << "\n";
+                continue;
+            }
+            for (const auto& kv : t) stages[kv.first].push_back(kv.second);
+            stages["total"].push_back(total_ms);
+        }
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < concurrency; ++i) threads.emplace_back(worker);
+    for (auto& th : threads) th.join();
+    double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    int ok = requests - failures.load();
+    std::cout << "requests: " << requests << "  ok: " << ok << "  failed: " << failures.load()
+              << "  concurrency: " << concurrency << "\n";
+    std::cout << std::fixed << std::setprecision(2)
+              << "wall: " << wall_s << " s  qps: " << (wall_s > 0 ? ok / wall_s : 0.0) << "\n";
+    std::cout << std::left << std::setw(10) << "stage" << std::right
+              << std::setw(12) << "p50_ms" << std::setw(12) << "p99_ms" << std::setw(12) << "mean_ms" << "\n";
+    for (auto& kv : stages) {
+        auto& v = kv.second;
+        double mean = 0.0;
+        for (double x : v) mean += x;
+        mean /= (double)v.size();
+        std::cout << std::left << std::setw(10) << kv.first << std::right
+                  << std::setw(12) << percentile(v, 0.50) << std::setw(12) << percentile(v, 0.99)
+                  << std::setw(12) << mean << "\n";
+    }
+    return failures.load() == 0 ? 0 : 1;
+}
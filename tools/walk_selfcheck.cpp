@@ -0,0 +1,179 @@
+// Self-check for the parallel directory walker and TextFileStream: builds a
+// tree under the temp directory, then compares walks at several thread counts
+// against a single-threaded recursive_directory_iterator listing and a list of
+// files the ignore patterns must (or must not) prune. Exits non-zero on failure.
+
+#include "io_utils.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond "\n"; \
+            ++g_failures;                                                        \
+        }                                                                        \
+    } while (0)
+
+using PathSet = std::set<std::string>;
+
+static void write_file(const fs::path& p, const std::string& content) {
+    fs::create_directories(p.parent_path());
+    std::ofstream(p, std::ios::binary) << content;
+}
+
+static PathSet to_set(const std::vector<std::string>& v) {
+    return PathSet(v.begin(), v.end());
+}
+
+static void check_glob() {
+    CHECK(glob_match("*", ""));
+    CHECK(glob_match("*", "anything"));
+    CHECK(glob_match("*.txt", "notes.txt"));
+    CHECK(!glob_match("*.txt", "notes.txt.bak"));
+    CHECK(glob_match("a?c", "abc"));
+    CHECK(!glob_match("a?c", "ac"));
+    CHECK(glob_match("*.old.*", "notes.old.txt"));
+    CHECK(glob_match("*a*b*c", "xxaxxbxxbxc"));  // needs backtracking past the first 'b'
+    CHECK(!glob_match("*a*b*c", "xxaxxbxxbx"));
+    CHECK(glob_match("drafts/*", "drafts/z.txt"));
+    CHECK(!glob_match("drafts/*", "keep/drafts/w.txt"));
+    CHECK(glob_match(".git", ".git"));
+    CHECK(!glob_match(".git", ".gitignore"));
+}
+
+int main() {
+    check_glob();
+
+    std::string tag = "rag_walk_selfcheck";
+#ifndef _WIN32
+    tag += "_" + std::to_string(getpid());
+#endif
+    const fs::path root = fs::temp_directory_path() / tag;
+    fs::remove_all(root);
+
+    // Bulk tree: enough directories that stealing actually happens.
+    for (int d = 0; d < 24; ++d) {
+        for (int s = 0; s < 6; ++s) {
+            const fs::path dir = root / ("d" + std::to_string(d)) / ("s" + std::to_string(s)) / "leaf";
+            for (int f = 0; f < 4; ++f) {
+                write_file(dir / ("f" + std::to_string(f) + ".txt"), "text " + std::to_string(d * 100 + f));
+            }
+            write_file(dir / "README.MD", "md");
+            write_file(dir / "skip.rst", "rst");
+            write_file(dir / "noext", "x");
+        }
+    }
+    const std::vector<std::string> patterns = {".git", "node_modules", "drafts/*", "*.old.*", "tmp?"};
+    // Pruned by `patterns`.
+    const std::vector<fs::path> ignored = {
+        root / ".git" / "objects" / "a.txt",
+        root / "node_modules" / "pkg" / "deep" / "b.md",
+        root / "d3" / "node_modules" / "c.txt",
+        root / "drafts" / "z.txt",
+        root / "d1" / "notes.old.txt",
+        root / "tmp1" / "t.txt",
+    };
+    // Look similar but must survive.
+    const std::vector<fs::path> kept = {
+        root / "keep" / "drafts" / "w.txt", // '/' patterns match the path relative to root
+        root / ".gitignore.txt",
+        root / "tmp12" / "t.txt",
+        root / "d2" / "notes.txt",
+    };
+    for (const auto& p : ignored) write_file(p, "ignored");
+    for (const auto& p : kept) write_file(p, "kept");
+
+    // Reference: single-threaded std::filesystem listing with the same extension filter.
+    PathSet all;
+    for (auto& e : fs::recursive_directory_iterator(root)) {
+        if (!e.is_regular_file()) continue;
+        std::string ext = e.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)tolower(c); });
+        if (ext == ".txt" || ext == ".md") all.insert(e.path().string());
+    }
+    PathSet expected = all;
+    for (const auto& p : ignored) expected.erase(p.string());
+    CHECK(all.size() == 24 * 6 * 5 + ignored.size() + kept.size());
+
+    for (int threads : {1, 2, 4, 8}) {
+        // Repeat to shake out termination races in the stealing loop.
+        for (int rep = 0; rep < 20; ++rep) {
+            WalkOptions opts;
+            opts.walk_threads = threads;
+            CHECK(to_set(list_text_files(root.string(), opts)) == all);
+
+            opts.ignore_patterns = patterns;
+            auto got = list_text_files(root.string(), opts);
+            CHECK(got.size() == expected.size()); // no duplicates
+            CHECK(to_set(got) == expected);
+        }
+    }
+
+    // Extensions are case-insensitive and accepted with or without the dot.
+    {
+        WalkOptions opts;
+        opts.extensions = {"RST"};
+        CHECK(list_text_files(root.string(), opts).size() == 24 * 6);
+        opts.extensions = {};
+        CHECK(list_text_files(root.string(), opts).size() == 24 * 6 * 7 + ignored.size() + kept.size());
+    }
+
+    // Stopping early returns promptly and leaves no walker running.
+    {
+        WalkOptions opts;
+        opts.walk_threads = 8;
+        int seen = 0;
+        walk_text_files(root.string(), opts, [&](const std::string&) { return ++seen < 5; });
+        CHECK(seen >= 5);
+    }
+
+    // The stream yields the single-walker discovery order regardless of reader count.
+    {
+        WalkOptions opts;
+        opts.walk_threads = 1;
+        const auto order = list_text_files(root.string(), opts);
+        for (int readers : {1, 4, 16}) {
+            opts.read_threads = readers;
+            opts.readahead = 3;
+            TextFileStream stream(root.string(), opts);
+            FileRecord rec;
+            std::vector<std::string> got;
+            while (stream.next(rec)) {
+                CHECK(rec.content == read_file_text(rec.path));
+                got.push_back(rec.path);
+            }
+            CHECK(got == order);
+        }
+        // Destroying a half-consumed stream must not hang.
+        TextFileStream partial(root.string(), opts);
+        FileRecord rec;
+        CHECK(partial.next(rec));
+    }
+
+    // Missing roots and single-file roots.
+    CHECK(list_text_files((root / "missing").string()).empty());
+    CHECK(list_text_files(kept.front().string()).size() == 1);
+
+    fs::remove_all(root);
+    if (g_failures) {
+        std::cerr << g_failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "walk_selfcheck: all checks passed\n";
+    return 0;
+}